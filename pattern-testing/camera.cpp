@@ -2,6 +2,7 @@
 #include "stdlib.h"
 
 #include "camera.h"
+#include "warmup_fit.h"
 
 using namespace royale;
 using namespace platform;
@@ -339,7 +340,7 @@ Camera::CameraError Camera::RunLensParametersTest() {
   return NONE;
 }
 
-Camera::CameraError Camera::RunTestReceiveData(int secondsToStream) {
+Camera::CameraError Camera::RunTestReceiveData(int secondsToStream, bool earlyStop) {
   // Let the camera run for a second
   std::this_thread::sleep_for (std::chrono::seconds (1));
 
@@ -359,13 +360,20 @@ Camera::CameraError Camera::RunTestReceiveData(int secondsToStream) {
   std::clog << "Begin Recording for " << secondsToStream << " seconds" << std::endl;
 
   rawListener_.m_count = 0u;
-  std::this_thread::sleep_for (std::chrono::seconds(secondsToStream));
+  float number_of_frames = 0.0f;
+  float streamedSeconds = static_cast<float>(secondsToStream);
+  if (!earlyStop) {
+    std::this_thread::sleep_for (std::chrono::seconds(secondsToStream));
+    number_of_frames = static_cast<float>(rawListener_.m_count.load());
+  } else {
+    StreamUntilStable (secondsToStream, number_of_frames, streamedSeconds);
+  }
 
   // Stop the recording
   camera_->stopRecording();
-  float number_of_frames = static_cast<float>(rawListener_.m_count);
 
   float current_temp = 0.0f;
+  std::unique_lock<std::mutex> tempLock (rawListener_.m_tempMutex);
   for (auto& tmp : rawListener_.m_cur_temp) {
     if (tmp <= 0) {
         std::cerr << "[ERROR] Temperature reading of " << tmp << " <= 0." << std::endl;
@@ -375,6 +383,7 @@ Camera::CameraError Camera::RunTestReceiveData(int secondsToStream) {
     }
   }
   std::clog << "[SUCCESS] Temperature sensor working, reading is " << current_temp << std::endl;
+  tempLock.unlock();
 
   // Stop the capturing mode
   royale::CameraStatus status = camera_->stopCapture();
@@ -383,13 +392,13 @@ Camera::CameraError Camera::RunTestReceiveData(int secondsToStream) {
               << royale::getStatusString(status).c_str() << std::endl;
     return RECEIVE_DATA_ERROR;
   }
-  float measuredFPS = number_of_frames / static_cast<float>(secondsToStream);
+  float measuredFPS = number_of_frames / streamedSeconds;
   float fps_lower_limit = static_cast<float>(fps_) - 0.5f;
   float fps_upper_limit = static_cast<float>(fps_) + 0.5f;
 
   if (measuredFPS < fps_lower_limit || measuredFPS > fps_upper_limit) {
     std::cerr << "[ERROR] FPS is outside of limits at " << measuredFPS << std::endl;
-    std::cerr << "[ERROR] " << rawListener_.m_count << " frames in " << secondsToStream << " seconds." << std::endl;
+    std::cerr << "[ERROR] " << number_of_frames << " frames in " << streamedSeconds << " seconds." << std::endl;
     return RECEIVE_DATA_ERROR;
   }
   std::clog << "[SUCCESS] FPS is inside limits " << measuredFPS << std::endl;
@@ -397,6 +406,55 @@ Camera::CameraError Camera::RunTestReceiveData(int secondsToStream) {
   return NONE;
 }
 
+void Camera::StreamUntilStable(int maxSeconds, float &numFrames, float &streamedSeconds) {
+  // The fit runs on one averaged sample per second of frames
+  WarmupCurveFit warmup (fps_);
+  // Fit the recording window only, frames from the earlier tests are skipped
+  size_t consumed;
+  {
+    std::lock_guard<std::mutex> lock (rawListener_.m_tempMutex);
+    consumed = rawListener_.m_cur_temp.size();
+  }
+
+  float fps_lower_limit = static_cast<float>(fps_) - 0.5f;
+  float fps_upper_limit = static_cast<float>(fps_) + 0.5f;
+
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::seconds (maxSeconds);
+  while (true) {
+    std::this_thread::sleep_for (std::chrono::seconds (1));
+    auto now = std::chrono::steady_clock::now();
+    numFrames = static_cast<float>(rawListener_.m_count.load());
+    streamedSeconds = std::chrono::duration<float> (now - start).count();
+    if (now >= deadline) {
+      std::clog << "Reached the streaming limit of " << maxSeconds << " seconds" << std::endl;
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock (rawListener_.m_tempMutex);
+      for (; consumed < rawListener_.m_cur_temp.size(); ++consumed) {
+        warmup.addFrame (rawListener_.m_cur_temp[consumed]);
+      }
+    }
+
+    float steadyState, bound;
+    if (!warmup.settled (streamedSeconds, steadyState, bound)) {
+      continue;
+    }
+
+    // The frame count is only known to +-1 frame at the sampling instant
+    bool fpsInSpec = (numFrames - 1.0f) / streamedSeconds >= fps_lower_limit &&
+                     (numFrames + 1.0f) / streamedSeconds <= fps_upper_limit;
+
+    if (fpsInSpec) {
+      std::clog << "Stopping early after " << streamedSeconds << " seconds, predicted steady-state temperature "
+                << steadyState << " +- " << bound << std::endl;
+      return;
+    }
+  }
+}
+
 Camera::CameraError Camera::RunProcessingParametersTests()
 {
     // Must be level 2.
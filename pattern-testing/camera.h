@@ -1,20 +1,26 @@
 #ifndef __CAMERA_H__
 #define __CAMERA_H__
 
+#include <atomic>
 #include <set>
 #include <string>
 #include <thread>
 #include <chrono>
+#include <functional>
+#include <mutex>
 
 #include <royale/ICameraDevice.hpp>
 #include <CameraFactory.hpp>
 
+#include "frame_pool.h"
+
 
 class MyRawListener : public royale::IExtendedDataListener
 {
 public:
     MyRawListener() :
-        m_count (0)
+        m_count (0),
+        m_framePool (nullptr)
     {
     }
 
@@ -29,14 +35,27 @@ public:
         }
         if (data->hasRawData()) {
           auto raw = data->getRawData();
+          std::lock_guard<std::mutex> lock (m_tempMutex);
           m_cur_temp.push_back(raw->illuminationTemperature);
         }
+
+        // The data is only valid during the callback, keep a copy for later analysis
+        if (m_framePool) {
+          FrameHandle frame = m_framePool->copyFrame (data);
+          if (frame && m_frameConsumer) {
+            m_frameConsumer (std::move (frame));
+          }
+        }
     }
 
     std::set<royale::StreamId> m_streamIds;
     royale::Vector<uint32_t> m_expoTimes;
-    int m_count;
+    std::atomic<int> m_count;
+    std::mutex m_tempMutex;                         // Guards m_cur_temp while streaming
     std::vector<float> m_cur_temp;
+    // Optional, set before capture starts; the consumer may hand frames to other threads
+    FramePool *m_framePool;
+    std::function<void (FrameHandle)> m_frameConsumer;
 };
 
 class Camera
@@ -81,7 +100,12 @@ public:
     CameraError RunStreamTests();
     CameraError RunUseCaseTests();
     CameraError RunLensParametersTest();
-    CameraError RunTestReceiveData(int secondsToStream);
+    // With earlyStop set, secondsToStream is a hard cap and the stream ends as
+    // soon as the warm-up fit and the FPS are confidently within spec.
+    CameraError RunTestReceiveData(int secondsToStream, bool earlyStop = false);
+
+private:
+    void StreamUntilStable(int maxSeconds, float &numFrames, float &streamedSeconds);
 };
 
 #endif // __CAMERA_H__
@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "frame_pool.h"
+
+FrameHandle::FrameHandle() :
+    m_pool (nullptr),
+    m_slot (0)
+{
+}
+
+FrameHandle::FrameHandle (FramePool *pool, size_t slot) :
+    m_pool (pool),
+    m_slot (slot)
+{
+}
+
+FrameHandle::FrameHandle (const FrameHandle &other) :
+    m_pool (other.m_pool),
+    m_slot (other.m_slot)
+{
+    if (m_pool)
+    {
+        m_pool->addRef (m_slot);
+    }
+}
+
+FrameHandle::FrameHandle (FrameHandle &&other) noexcept :
+    m_pool (other.m_pool),
+    m_slot (other.m_slot)
+{
+    other.m_pool = nullptr;
+}
+
+FrameHandle &FrameHandle::operator= (FrameHandle other)
+{
+    std::swap (m_pool, other.m_pool);
+    std::swap (m_slot, other.m_slot);
+    return *this;
+}
+
+FrameHandle::~FrameHandle()
+{
+    reset();
+}
+
+void FrameHandle::reset()
+{
+    if (m_pool)
+    {
+        m_pool->release (m_slot);
+        m_pool = nullptr;
+    }
+}
+
+uint16_t FrameHandle::width() const
+{
+    return m_pool->m_slots[m_slot].width;
+}
+
+uint16_t FrameHandle::height() const
+{
+    return m_pool->m_slots[m_slot].height;
+}
+
+royale::StreamId FrameHandle::streamId() const
+{
+    return m_pool->m_slots[m_slot].streamId;
+}
+
+std::chrono::microseconds FrameHandle::timeStamp() const
+{
+    return m_pool->m_slots[m_slot].timeStamp;
+}
+
+float FrameHandle::illuminationTemperature() const
+{
+    return m_pool->m_slots[m_slot].illuminationTemperature;
+}
+
+size_t FrameHandle::numPhases() const
+{
+    return m_pool->m_slots[m_slot].numPhases;
+}
+
+const uint16_t *FrameHandle::phase (size_t index) const
+{
+    return &m_pool->m_rawSlab[(m_slot * m_pool->m_maxPhases + index) * m_pool->m_pixels];
+}
+
+size_t FrameHandle::numExposureTimes() const
+{
+    return m_pool->m_slots[m_slot].numExposures;
+}
+
+const uint32_t *FrameHandle::exposureTimes() const
+{
+    return &m_pool->m_exposureSlab[m_slot * m_pool->m_maxPhases];
+}
+
+size_t FrameHandle::numModulationFrequencies() const
+{
+    return m_pool->m_slots[m_slot].numFrequencies;
+}
+
+const uint32_t *FrameHandle::modulationFrequencies() const
+{
+    return &m_pool->m_modulationSlab[m_slot * m_pool->m_maxPhases];
+}
+
+bool FrameHandle::hasDepthData() const
+{
+    return m_pool->m_slots[m_slot].hasDepth;
+}
+
+size_t FrameHandle::numDepthPoints() const
+{
+    return m_pool->m_slots[m_slot].numDepthPoints;
+}
+
+const royale::DepthPoint *FrameHandle::depthPoints() const
+{
+    return &m_pool->m_depthSlab[m_slot * m_pool->m_pixels];
+}
+
+FramePool::FramePool (uint16_t maxWidth, uint16_t maxHeight, size_t maxPhases, size_t numSlots) :
+    m_maxWidth (maxWidth),
+    m_maxHeight (maxHeight),
+    m_maxPhases (maxPhases),
+    m_numSlots (numSlots),
+    m_pixels (static_cast<size_t> (maxWidth) * maxHeight),
+    m_slots (new Slot[numSlots]),
+    m_rawSlab (numSlots * maxPhases * m_pixels),
+    m_depthSlab (numSlots * m_pixels),
+    m_exposureSlab (numSlots * maxPhases),
+    m_modulationSlab (numSlots * maxPhases),
+    m_dropped (0)
+{
+    m_freeList.reserve (numSlots);
+    for (size_t i = numSlots; i > 0; --i)
+    {
+        m_slots[i - 1].refCount = 0;
+        m_freeList.push_back (i - 1);
+    }
+}
+
+FrameHandle FramePool::copyFrame (const royale::IExtendedData *data)
+{
+    const royale::RawData *raw = data->hasRawData() ? data->getRawData() : nullptr;
+    const royale::DepthData *depth = data->hasDepthData() ? data->getDepthData() : nullptr;
+
+    if ((raw == nullptr && depth == nullptr) ||
+        (raw && (raw->width > m_maxWidth || raw->height > m_maxHeight ||
+                 raw->rawData.size() > m_maxPhases ||
+                 raw->exposureTimes.size() > m_maxPhases ||
+                 raw->modulationFrequencies.size() > m_maxPhases)) ||
+        (depth && (depth->width > m_maxWidth || depth->height > m_maxHeight ||
+                   depth->points.size() > m_pixels)))
+    {
+        m_dropped++;
+        return FrameHandle();
+    }
+
+    size_t index;
+    {
+        std::lock_guard<std::mutex> lock (m_freeMutex);
+        if (m_freeList.empty())
+        {
+            m_dropped++;
+            return FrameHandle();
+        }
+        index = m_freeList.back();
+        m_freeList.pop_back();
+    }
+
+    Slot &slot = m_slots[index];
+    slot.width = raw ? raw->width : depth->width;
+    slot.height = raw ? raw->height : depth->height;
+    slot.numPhases = 0;
+    slot.numExposures = 0;
+    slot.numFrequencies = 0;
+    slot.numDepthPoints = 0;
+    slot.hasDepth = depth != nullptr;
+
+    if (raw)
+    {
+        slot.streamId = raw->streamId;
+        slot.timeStamp = raw->timeStamp;
+        slot.illuminationTemperature = raw->illuminationTemperature;
+        slot.numPhases = raw->rawData.size();
+        size_t pixels = static_cast<size_t> (raw->width) * raw->height;
+        for (size_t i = 0; i < slot.numPhases; ++i)
+        {
+            std::memcpy (&m_rawSlab[(index * m_maxPhases + i) * m_pixels],
+                         raw->rawData[i], pixels * sizeof (uint16_t));
+        }
+        slot.numExposures = raw->exposureTimes.size();
+        std::copy (raw->exposureTimes.begin(), raw->exposureTimes.end(),
+                   m_exposureSlab.begin() + index * m_maxPhases);
+        slot.numFrequencies = raw->modulationFrequencies.size();
+        std::copy (raw->modulationFrequencies.begin(), raw->modulationFrequencies.end(),
+                   m_modulationSlab.begin() + index * m_maxPhases);
+    }
+    if (depth)
+    {
+        if (!raw)
+        {
+            slot.streamId = depth->streamId;
+            slot.timeStamp = depth->timeStamp;
+            slot.illuminationTemperature = 0.0f;
+        }
+        slot.numDepthPoints = depth->points.size();
+        std::copy (depth->points.begin(), depth->points.end(),
+                   m_depthSlab.begin() + index * m_pixels);
+    }
+
+    slot.refCount.store (1);
+    return FrameHandle (this, index);
+}
+
+size_t FramePool::numFree() const
+{
+    std::lock_guard<std::mutex> lock (m_freeMutex);
+    return m_freeList.size();
+}
+
+void FramePool::addRef (size_t slot)
+{
+    m_slots[slot].refCount.fetch_add (1, std::memory_order_relaxed);
+}
+
+void FramePool::release (size_t slot)
+{
+    if (m_slots[slot].refCount.fetch_sub (1, std::memory_order_acq_rel) == 1)
+    {
+        // Never reallocates, the free list was reserved for all slots.
+        std::lock_guard<std::mutex> lock (m_freeMutex);
+        m_freeList.push_back (slot);
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef __FRAME_POOL_H__
+#define __FRAME_POOL_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <royale/IExtendedData.hpp>
+
+class FramePool;
+
+// Reference-counted handle to a frame copied into a FramePool. Handles can be
+// copied and passed to other threads; the slot goes back to the pool when the
+// last handle is released. The pool must outlive all of its handles.
+class FrameHandle
+{
+public:
+    FrameHandle();
+    FrameHandle (const FrameHandle &other);
+    FrameHandle (FrameHandle &&other) noexcept;
+    FrameHandle &operator= (FrameHandle other);
+    ~FrameHandle();
+
+    inline bool valid() const { return m_pool != nullptr; }
+    explicit operator bool() const { return valid(); }
+    void reset();
+
+    uint16_t width() const;
+    uint16_t height() const;
+    royale::StreamId streamId() const;
+    std::chrono::microseconds timeStamp() const;
+    float illuminationTemperature() const;
+
+    size_t numPhases() const;
+    const uint16_t *phase (size_t index) const;
+    size_t numExposureTimes() const;
+    const uint32_t *exposureTimes() const;
+    size_t numModulationFrequencies() const;
+    const uint32_t *modulationFrequencies() const;
+
+    bool hasDepthData() const;
+    size_t numDepthPoints() const;
+    const royale::DepthPoint *depthPoints() const;
+
+private:
+    friend class FramePool;
+    FrameHandle (FramePool *pool, size_t slot);
+
+    FramePool *m_pool;
+    size_t m_slot;
+};
+
+// Fixed-size pool of preallocated frame buffers. All memory is allocated in
+// the constructor for the largest frame to be kept, so copying frames out of
+// onNewData does not touch the heap at steady state.
+class FramePool
+{
+public:
+    // Frames up to maxWidth x maxHeight with up to maxPhases raw buffers fit.
+    FramePool (uint16_t maxWidth, uint16_t maxHeight, size_t maxPhases, size_t numSlots);
+
+    FramePool (const FramePool &) = delete;
+    FramePool &operator= (const FramePool &) = delete;
+
+    // Deep copies the frame. Returns an invalid handle if the pool is
+    // exhausted or the frame does not fit the configured size.
+    FrameHandle copyFrame (const royale::IExtendedData *data);
+
+    size_t numFree() const;
+    inline size_t numSlots() const { return m_numSlots; }
+    inline uint64_t numDropped() const { return m_dropped.load(); }
+
+private:
+    friend class FrameHandle;
+
+    struct Slot
+    {
+        std::atomic<int> refCount;
+        royale::StreamId streamId;
+        std::chrono::microseconds timeStamp;
+        uint16_t width;
+        uint16_t height;
+        size_t numPhases;
+        size_t numExposures;
+        size_t numFrequencies;
+        size_t numDepthPoints;
+        float illuminationTemperature;
+        bool hasDepth;
+    };
+
+    void addRef (size_t slot);
+    void release (size_t slot);
+
+    const uint16_t m_maxWidth;
+    const uint16_t m_maxHeight;
+    const size_t m_maxPhases;
+    const size_t m_numSlots;
+    const size_t m_pixels;
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::vector<uint16_t> m_rawSlab;                // m_numSlots * m_maxPhases * m_pixels
+    std::vector<royale::DepthPoint> m_depthSlab;    // m_numSlots * m_pixels
+    std::vector<uint32_t> m_exposureSlab;           // m_numSlots * m_maxPhases
+    std::vector<uint32_t> m_modulationSlab;         // m_numSlots * m_maxPhases
+
+    mutable std::mutex m_freeMutex;                 // Guards m_freeList
+    std::vector<size_t> m_freeList;
+    std::atomic<uint64_t> m_dropped;
+};
+
+#endif // __FRAME_POOL_H__
@@ -0,0 +1,151 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "frame_pool.h"
+#include "synthetic_data.h"
+
+static_assert (std::is_nothrow_move_constructible<FrameHandle>::value,
+               "std::vector<FrameHandle> must move handles on reallocation");
+
+static std::atomic<int> failures (0);
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cerr << "[ERROR] " << __FILE__ << ":" << __LINE__ << " " #cond << std::endl; \
+            failures++; \
+        } \
+    } while (0)
+
+static void testExhaustion()
+{
+    FramePool pool (8, 4, 5, 2);
+    SyntheticData data (8, 4, 5, 2, 1);
+
+    FrameHandle first = pool.copyFrame (&data);
+    FrameHandle second = pool.copyFrame (&data);
+    FrameHandle third = pool.copyFrame (&data);
+    CHECK (first.valid());
+    CHECK (second.valid());
+    CHECK (!third.valid());
+    CHECK (pool.numFree() == 0u);
+    CHECK (pool.numDropped() == 1u);
+
+    first.reset();
+    CHECK (pool.numFree() == 1u);
+    CHECK (pool.copyFrame (&data).valid());
+    CHECK (pool.numFree() == 1u);
+}
+
+static void testRefCounts()
+{
+    FramePool pool (8, 4, 5, 1);
+    SyntheticData data (8, 4, 5, 2, 1);
+
+    FrameHandle handle = pool.copyFrame (&data);
+    {
+        FrameHandle copy (handle);
+        FrameHandle assigned;
+        assigned = handle;
+        handle.reset();
+        CHECK (pool.numFree() == 0u);
+
+        FrameHandle moved (std::move (copy));
+        CHECK (!copy.valid());
+        CHECK (moved.valid());
+        assigned = FrameHandle();
+        CHECK (pool.numFree() == 0u);
+    }
+    CHECK (pool.numFree() == 1u);
+
+    // Reallocation moves handles instead of copying them
+    std::vector<FrameHandle> handles;
+    handles.push_back (pool.copyFrame (&data));
+    for (int i = 0; i < 8; ++i)
+    {
+        handles.push_back (FrameHandle());
+    }
+    CHECK (handles.front().valid());
+    handles.clear();
+    CHECK (pool.numFree() == 1u);
+}
+
+static void testSizes()
+{
+    FramePool pool (8, 4, 5, 2);
+
+    SyntheticData tooWide (9, 4, 5, 2, 1);
+    SyntheticData tooManyPhases (8, 4, 6, 2, 1);
+    CHECK (!pool.copyFrame (&tooWide).valid());
+    CHECK (!pool.copyFrame (&tooManyPhases).valid());
+    CHECK (pool.numDropped() == 2u);
+    CHECK (pool.numFree() == 2u);
+
+    // Reuse a slot with fewer entries than before; the counts must follow
+    SyntheticData full (8, 4, 5, 5, 7);
+    pool.copyFrame (&full).reset();
+    pool.copyFrame (&full).reset();
+
+    SyntheticData small (4, 2, 3, 1, 9);
+    FrameHandle frame = pool.copyFrame (&small);
+    CHECK (frame.valid());
+    CHECK (frame.width() == 4u);
+    CHECK (frame.height() == 2u);
+    CHECK (frame.numPhases() == 3u);
+    CHECK (frame.numExposureTimes() == 1u);
+    CHECK (frame.numModulationFrequencies() == 3u);
+    CHECK (frame.numDepthPoints() == 8u);
+    CHECK (frame.exposureTimes()[0] == 9u);
+    CHECK (frame.phase (2)[7] == 9u);
+}
+
+static void testWorkerRelease()
+{
+    FramePool pool (8, 4, 5, 4);
+    SyntheticData data (8, 4, 5, 2, 3);
+
+    // Workers hold their frames until all slots are known to be taken
+    std::atomic<bool> go (false);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 4; ++i)
+    {
+        FrameHandle frame = pool.copyFrame (&data);
+        CHECK (frame.valid());
+        workers.push_back (std::thread ([frame, &go] () {
+            while (!go.load())
+            {
+                std::this_thread::yield();
+            }
+            CHECK (frame.phase (0)[0] == 3u);
+        }));
+    }
+    CHECK (!pool.copyFrame (&data).valid());
+    go.store (true);
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    workers.clear();
+    CHECK (pool.numFree() == 4u);
+}
+
+int main()
+{
+    testExhaustion();
+    testRefCounts();
+    testSizes();
+    testWorkerRelease();
+
+    if (failures.load() != 0)
+    {
+        std::cerr << "[ERROR] " << failures.load() << " frame pool check(s) failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::clog << "[SUCCESS] All frame pool tests passed. " << std::endl;
+    return 0;
+}
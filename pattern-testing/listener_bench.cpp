@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+#include <getopt.h>
+
+#include "camera.h"
+#include "synthetic_data.h"
+
+// Every heap allocation made by this process goes through here so that the
+// benchmark can report how many allocations the callback path costs per frame.
+static std::atomic<uint64_t> g_allocations (0);
+
+void *operator new (std::size_t size)
+{
+    g_allocations.fetch_add (1, std::memory_order_relaxed);
+    void *p = std::malloc (size ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+// Kept out of line, otherwise GCC sees free() inlined against operator new
+// and warns about a mismatched deallocation.
+__attribute__ ((noinline)) void operator delete (void *p) noexcept
+{
+    std::free (p);
+}
+
+void *operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void operator delete[] (void *p) noexcept
+{
+    operator delete (p);
+}
+
+struct BenchCase
+{
+    std::string name;
+    uint16_t width;
+    uint16_t height;
+    size_t numPhases;
+    uint16_t fps;
+};
+
+struct BenchResult
+{
+    double ns_per_frame_min;
+    double ns_per_frame_median;
+    uint64_t allocations;
+    uint64_t frames;
+};
+
+// Slots in the frame pool for the capture variant; frames are released by
+// the consumer right away, so one slot would do, but keep a realistic depth.
+static const size_t POOL_SLOTS = 8;
+
+static BenchResult runCase (const BenchCase& bc, uint64_t numFrames, int repetitions, bool withPool)
+{
+    SyntheticData data (bc.width, bc.height, bc.numPhases, bc.numPhases, 0x0400);
+
+    // Timestamps and temperatures of a warming module, computed up front so
+    // the timed loop measures the callback and not the generator.
+    std::vector<std::chrono::microseconds> timeStamps (numFrames);
+    std::vector<float> temperatures (numFrames);
+    for (uint64_t i = 0; i < numFrames; ++i)
+    {
+        timeStamps[i] = std::chrono::microseconds (i * 1000000u / bc.fps);
+        temperatures[i] = 30.0f + 15.0f * (1.0f - 1.0f / (1.0f + i * 0.001f));
+    }
+
+    std::vector<double> samples;
+    samples.reserve (repetitions);
+    uint64_t allocations = 0;
+
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        // A fresh listener per repetition, as the camera gets for each run.
+        FramePool pool (bc.width, bc.height, bc.numPhases, POOL_SLOTS);
+        MyRawListener listener;
+        if (withPool)
+        {
+            listener.m_framePool = &pool;
+            listener.m_frameConsumer = [] (FrameHandle) {};
+        }
+
+        // Warm up caches and the listener's containers before timing.
+        for (uint64_t i = 0; i < std::min<uint64_t> (16u, numFrames); ++i)
+        {
+            data.setFrame (timeStamps[i], temperatures[i]);
+            listener.onNewData (&data);
+        }
+
+        uint64_t allocsBefore = g_allocations.load (std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < numFrames; ++i)
+        {
+            data.setFrame (timeStamps[i], temperatures[i]);
+            listener.onNewData (&data);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        allocations += g_allocations.load (std::memory_order_relaxed) - allocsBefore;
+
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds> (stop - start).count();
+        samples.push_back (static_cast<double> (ns) / static_cast<double> (numFrames));
+    }
+
+    std::sort (samples.begin(), samples.end());
+    BenchResult result;
+    result.ns_per_frame_min = samples.front();
+    result.ns_per_frame_median = samples[samples.size() / 2];
+    result.allocations = allocations;
+    result.frames = numFrames * repetitions;
+    return result;
+}
+
+void print_help() {
+  std::cout <<
+        "-n <n>               Set number of frames per repetition: -n 100000\n"
+        "-r <n>               Set number of repetitions: -r 5\n"
+        "-h                   Show help\n";
+  exit(EXIT_FAILURE);
+}
+
+#define OPTSTR "n:r:h"
+
+int main (int argc, char **argv)
+{
+    int opt;
+    uint64_t numFrames = 100000u;
+    int repetitions = 5;
+
+    while ((opt = getopt (argc, argv, OPTSTR)) != -1) {
+      switch (opt) {
+        case 'n':
+          numFrames = std::max (1, std::stoi (optarg));
+          break;
+        case 'r':
+          repetitions = std::max (1, std::stoi (optarg));
+          break;
+        case 'h':
+        default:
+          print_help();
+          break;
+      }
+    }
+
+    // Resolutions and rates of the use cases the acceptance test runs against.
+    // The raw frame carries one buffer per phase (grey + 2x4 phases).
+    const std::vector<BenchCase> cases = {
+        { "MODE_9_5FPS",   224, 172, 9, 5 },
+        { "MODE_9_10FPS",  224, 172, 9, 10 },
+        { "MODE_9_15FPS",  224, 172, 9, 15 },
+        { "MODE_9_25FPS",  224, 172, 9, 25 },
+        { "MODE_5_35FPS",  224, 172, 5, 35 },
+        { "MODE_5_45FPS",  224, 172, 5, 45 },
+        { "MODE_5_60FPS",  224, 172, 5, 60 },
+    };
+
+    // One line per case with fixed keys, so that runs from different commits
+    // can be diffed or parsed directly.
+    int failures = 0;
+    for (const auto& bc : cases)
+    for (bool withPool : { false, true })
+    {
+        BenchResult r = runCase (bc, numFrames, repetitions, withPool);
+        double budget_ns = 1e9 / bc.fps;
+        double max_fps = 1e9 / r.ns_per_frame_median;
+        double allocs_per_frame = static_cast<double> (r.allocations) / static_cast<double> (r.frames);
+        bool ok = r.ns_per_frame_median < budget_ns;
+        if (!ok)
+        {
+            failures++;
+        }
+
+        std::cout << std::fixed << std::setprecision (2)
+                  << "BENCH " << (withPool ? "listener+pool" : "listener")
+                  << " use_case=" << bc.name
+                  << " resolution=" << bc.width << "x" << bc.height
+                  << " fps=" << bc.fps
+                  << " frames=" << numFrames
+                  << " reps=" << repetitions
+                  << " ns_per_frame_min=" << r.ns_per_frame_min
+                  << " ns_per_frame_median=" << r.ns_per_frame_median
+                  << " max_fps=" << max_fps
+                  << " allocs=" << r.allocations
+                  << " alloc_frames=" << r.frames
+                  // Amortised costs are far below 1, keep them visible
+                  << std::scientific << std::setprecision (3)
+                  << " allocs_per_frame=" << allocs_per_frame
+                  << " budget_used_pct=" << 100.0 * r.ns_per_frame_median / budget_ns
+                  << " status=" << (ok ? "OK" : "TOO_SLOW")
+                  << std::endl;
+    }
+
+    if (failures != 0)
+    {
+        std::cerr << "[ERROR] " << failures << " use case(s) exceed the frame budget." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::clog << "[SUCCESS] Listener keeps up with all use cases. " << std::endl;
+    return 0;
+}
@@ -18,23 +18,25 @@ void print_help() {
         "-v                   Show program version.\n"
         "-r <n>               Set number of seconds to record: -r 60\n"
         "-m <str>             Set ToF mode: -m MODE_9_5FPS\n"
+        "-e                   Stop streaming early once temperature and FPS are stable\n"
         "-h                   Show help\n";
   exit(EXIT_FAILURE);
 }
 
-#define OPTSTR "vr:m:h"
+#define OPTSTR "vr:m:eh"
 
 typedef struct {
   string         version;
   int            numSecondsToStream;
   royale::String test_mode;
+  bool           earlyStop;
 } options_t;
 
 int main(int argc, char **argv)
 {
     int opt;
     // Default options
-    options_t options = { VERSION, 15, "MODE_9_5FPS" };
+    options_t options = { VERSION, 15, "MODE_9_5FPS", false };
     // std::string ACCESS_CODE = "d79dab562f13ef8373e906d919aec323a2857388";
     std::string ACCESS_CODE = "c715e2ca31e816b1ef17ba487e2a5e9efc6bbd7b";
     // CameraFactory factory;
@@ -62,6 +64,10 @@ int main(int argc, char **argv)
             options.test_mode = royale::String(optarg);
             std::cout << "Setting ToF Mode: " << options.test_mode << std::endl;
             break;
+          case 'e':
+            options.earlyStop = true;
+            std::cout << "Early Stop Enabled, Streaming Time is the upper limit." << std::endl;
+            break;
           case 'h':
           default:
             print_help();
@@ -105,7 +111,7 @@ int main(int argc, char **argv)
 //    if (EXIT_ON_ERROR && error != Camera::CameraError::NONE) { return error; }
 //
 //    // [Streaming] Test Receive Data
-//    error = cam.RunTestReceiveData(options.numSecondsToStream);
+//    error = cam.RunTestReceiveData(options.numSecondsToStream, options.earlyStop);
 //    if (EXIT_ON_ERROR && error != Camera::CameraError::NONE) { return error; }
 
     return 0;
@@ -0,0 +1,61 @@
+#ifndef __SYNTHETIC_DATA_H__
+#define __SYNTHETIC_DATA_H__
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <royale/IExtendedData.hpp>
+
+// Fake frame handed to listeners and pools in place of the camera's own data.
+// Every raw phase pixel, exposure time and modulation frequency holds fill,
+// and all buffers are allocated up front.
+class SyntheticData : public royale::IExtendedData
+{
+public:
+    SyntheticData (uint16_t width, uint16_t height, size_t numPhases, size_t numExposures, uint16_t fill) :
+        m_phases (numPhases, std::vector<uint16_t> (width * height, fill))
+    {
+        m_raw.width = width;
+        m_raw.height = height;
+        m_raw.streamId = 1;
+        m_raw.illuminationTemperature = 30.0f;
+        for (auto& phase : m_phases)
+        {
+            m_raw.rawData.push_back (phase.data());
+            m_raw.modulationFrequencies.push_back (fill);
+        }
+        for (size_t i = 0; i < numExposures; ++i)
+        {
+            m_raw.exposureTimes.push_back (fill);
+        }
+
+        m_depth.width = width;
+        m_depth.height = height;
+        m_depth.streamId = 1;
+        m_depth.exposureTimes = m_raw.exposureTimes;
+        m_depth.points.resize (width * height);
+    }
+
+    // Only stores, so that it costs next to nothing inside a timed loop
+    void setFrame (std::chrono::microseconds timeStamp, float temperature)
+    {
+        m_raw.timeStamp = timeStamp;
+        m_depth.timeStamp = timeStamp;
+        m_raw.illuminationTemperature = temperature;
+    }
+
+    bool hasDepthData() const override { return true; }
+    bool hasRawData() const override { return true; }
+    bool hasIntermediateData() const override { return false; }
+    const royale::DepthData *getDepthData() const override { return &m_depth; }
+    const royale::RawData *getRawData() const override { return &m_raw; }
+    const royale::IntermediateData *getIntermediateData() const override { return nullptr; }
+
+private:
+    std::vector<std::vector<uint16_t>> m_phases;
+    royale::RawData m_raw;
+    royale::DepthData m_depth;
+};
+
+#endif // __SYNTHETIC_DATA_H__
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cmath>
+
+#include "warmup_fit.h"
+
+namespace
+{
+    // Minimum number of (T[k-1], T[k], T[k+1]) triples before a prediction is attempted
+    const double MIN_TRIPLES = 20.0;
+    // Significance, in standard deviations, required of 0 < a < 1
+    const double A_SIGMAS = 3.0;
+    // The window must span this many fitted time constants
+    const double MIN_TIME_CONSTANTS = 3.0;
+}
+
+constexpr float WarmupCurveFit::CONFIDENCE;
+constexpr float WarmupCurveFit::MIN_SECONDS;
+
+WarmupCurveFit::WarmupCurveFit (size_t framesPerSample) :
+    m_framesPerSample (framesPerSample > 0 ? framesPerSample : 1u),
+    m_frameSum (0.0),
+    m_frameCount (0),
+    m_numSamples (0),
+    m_prev2 (0.0),
+    m_prev (0.0),
+    m_n (0.0),
+    m_sz (0.0),
+    m_sx (0.0),
+    m_sy (0.0),
+    m_szz (0.0),
+    m_szx (0.0),
+    m_szy (0.0),
+    m_sxx (0.0),
+    m_sxy (0.0),
+    m_syy (0.0)
+{
+}
+
+void WarmupCurveFit::addFrame (float temperature)
+{
+    m_frameSum += temperature;
+    if (++m_frameCount == m_framesPerSample)
+    {
+        addSample (static_cast<float> (m_frameSum / static_cast<double> (m_frameCount)));
+        m_frameSum = 0.0;
+        m_frameCount = 0;
+    }
+}
+
+void WarmupCurveFit::addSample (float temperature)
+{
+    double t = static_cast<double> (temperature);
+    if (m_numSamples > 1)
+    {
+        m_n += 1.0;
+        m_sz += m_prev2;
+        m_sx += m_prev;
+        m_sy += t;
+        m_szz += m_prev2 * m_prev2;
+        m_szx += m_prev2 * m_prev;
+        m_szy += m_prev2 * t;
+        m_sxx += m_prev * m_prev;
+        m_sxy += m_prev * t;
+        m_syy += t * t;
+    }
+    m_prev2 = m_prev;
+    m_prev = t;
+    m_numSamples++;
+}
+
+bool WarmupCurveFit::predict (float tolerance, float &steadyState, float &stdDev) const
+{
+    if (m_n < MIN_TRIPLES)
+    {
+        return false;
+    }
+
+    double zmean = m_sz / m_n;
+    double xmean = m_sx / m_n;
+    double ymean = m_sy / m_n;
+    double czz = m_szz - m_n * zmean * zmean;
+    double czx = m_szx - m_n * zmean * xmean;
+    double czy = m_szy - m_n * zmean * ymean;
+    double cxx = m_sxx - m_n * xmean * xmean;
+    double cxy = m_sxy - m_n * xmean * ymean;
+    double cyy = m_syy - m_n * ymean * ymean;
+
+    // No trend to follow: a flat (or quantised) stretch says nothing about
+    // whether the module has finished warming up.
+    if (czx <= 0.0)
+    {
+        return false;
+    }
+
+    double a = czy / czx;
+    double b = ymean - a * xmean;
+    double residual = std::max (cyy - 2.0 * a * cxy + a * a * cxx, 0.0) / std::max (m_n - 2.0, 1.0);
+    double varA = residual * czz / (czx * czx);
+    double sigmaA = std::sqrt (varA);
+
+    // The curve must be significantly converging, i.e. 0 < a < 1 with margin.
+    if (a - A_SIGMAS * sigmaA <= 0.0 || a + A_SIGMAS * sigmaA >= 1.0)
+    {
+        return false;
+    }
+
+    // ...and the window must already cover several time constants of it.
+    double tau = -1.0 / std::log (a);
+    if (static_cast<double> (m_numSamples) < MIN_TIME_CONSTANTS * tau)
+    {
+        return false;
+    }
+
+    // Propagate the uncertainty of (a, b) to T_inf = b / (1 - a).
+    double varB = residual / m_n + xmean * xmean * varA;
+    double covAB = -xmean * varA;
+    double dA = b / ((1.0 - a) * (1.0 - a));
+    double dB = 1.0 / (1.0 - a);
+    double var = dA * dA * varA + dB * dB * varB + 2.0 * dA * dB * covAB;
+    double prediction = b / (1.0 - a);
+
+    // The latest reading must already have arrived at the prediction.
+    if (std::fabs (m_prev - prediction) > tolerance)
+    {
+        return false;
+    }
+
+    steadyState = static_cast<float> (prediction);
+    stdDev = static_cast<float> (std::sqrt (std::max (var, 0.0)));
+    return true;
+}
+
+bool WarmupCurveFit::settled (float elapsedSeconds, float &steadyState, float &bound) const
+{
+    float stdDev;
+    if (elapsedSeconds < MIN_SECONDS || !predict (CONFIDENCE, steadyState, stdDev))
+    {
+        return false;
+    }
+    bound = 2.0f * stdDev;
+    return bound <= CONFIDENCE && steadyState - bound > 0.0f;
+}
@@ -0,0 +1,65 @@
+#ifndef __WARMUP_FIT_H__
+#define __WARMUP_FIT_H__
+
+#include <cstddef>
+
+// Incremental fit of an exponential warm-up curve
+//
+//     T(t) = T_inf - (T_inf - T_0) * exp(-t / tau)
+//
+// to equally spaced temperature samples. For equal spacing the curve obeys
+// T[k+1] = a * T[k] + b with a = exp(-dt / tau) and b = T_inf * (1 - a), so
+// running sums are enough to estimate T_inf = b / (1 - a) in O(1) per sample.
+//
+// Sensor noise on the regressor T[k] would bias a plain least-squares a
+// towards 0 and the prediction towards the sample mean, so T[k-1] is used
+// as an instrument for T[k] instead.
+class WarmupCurveFit
+{
+public:
+    // Required 2-sigma bound on the predicted steady state [degC]
+    static constexpr float CONFIDENCE = 1.0f;
+    // Never settled before the shortest regular streaming time [s]
+    static constexpr float MIN_SECONDS = 10.0f;
+
+    // Frames are averaged framesPerSample at a time into one fit sample,
+    // e.g. the frame rate for one sample per second.
+    explicit WarmupCurveFit (size_t framesPerSample = 1);
+
+    void addFrame (float temperature);
+    void addSample (float temperature);
+
+    // The stop rule for streaming: true once elapsedSeconds reaches
+    // MIN_SECONDS and predict() gives a positive steady state whose 2-sigma
+    // bound is within CONFIDENCE.
+    bool settled (float elapsedSeconds, float &steadyState, float &bound) const;
+
+    // Returns false unless the samples show a converging curve that the
+    // window covers several time constants of, and the latest sample is
+    // within tolerance of the predicted steady state.
+    bool predict (float tolerance, float &steadyState, float &stdDev) const;
+
+    inline size_t numSamples() const { return m_numSamples; }
+
+private:
+    size_t m_framesPerSample;
+    double m_frameSum;
+    size_t m_frameCount;
+
+    size_t m_numSamples;
+    double m_prev2;
+    double m_prev;
+    // Running sums over (z, x, y) = (T[k-1], T[k], T[k+1]) triples
+    double m_n;
+    double m_sz;
+    double m_sx;
+    double m_sy;
+    double m_szz;
+    double m_szx;
+    double m_szy;
+    double m_sxx;
+    double m_sxy;
+    double m_syy;
+};
+
+#endif // __WARMUP_FIT_H__
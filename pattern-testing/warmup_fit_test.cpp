@@ -0,0 +1,131 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "warmup_fit.h"
+
+// Deterministic normal noise, independent of the standard library's distributions
+class Noise
+{
+public:
+    explicit Noise (uint32_t seed) : m_state (seed) {}
+
+    double next()
+    {
+        double u1 = (uniform() + 1.0) / 4294967297.0;
+        double u2 = uniform() / 4294967296.0;
+        return std::sqrt (-2.0 * std::log (u1)) * std::cos (6.283185307179586 * u2);
+    }
+
+private:
+    double uniform()
+    {
+        m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double> (m_state >> 32);
+    }
+
+    uint64_t m_state;
+};
+
+struct Curve
+{
+    std::string name;
+    double startTemp;
+    double steadyTemp;
+    double tau;             // [s]
+    int fps;
+    double noise;           // per frame [degC]
+    double quantisation;    // sensor resolution [degC], 0 for none
+    int maxSeconds;
+    bool mustStop;          // the curve settles well within maxSeconds
+};
+
+// Streams the curve one frame at a time through the stop rule, fitting one
+// sample per second of frames as Camera::StreamUntilStable does. Returns
+// false if the rule stops on a prediction that is wrong by more than
+// WarmupCurveFit::CONFIDENCE.
+static bool runCurve (const Curve& c)
+{
+    Noise noise (12345u);
+    WarmupCurveFit fit (c.fps);
+
+    for (int frame = 0; frame < c.maxSeconds * c.fps; ++frame)
+    {
+        double t = static_cast<double> (frame) / c.fps;
+        double temp = c.steadyTemp - (c.steadyTemp - c.startTemp) * std::exp (-t / c.tau);
+        temp += c.noise * noise.next();
+        if (c.quantisation > 0.0)
+        {
+            temp = c.quantisation * std::floor (temp / c.quantisation + 0.5);
+        }
+
+        fit.addFrame (static_cast<float> (temp));
+
+        // StreamUntilStable checks once per second
+        if ((frame + 1) % c.fps != 0)
+        {
+            continue;
+        }
+        float seconds = static_cast<float> (frame + 1) / c.fps;
+        float steadyState, bound;
+        if (!fit.settled (seconds, steadyState, bound))
+        {
+            continue;
+        }
+
+        float error = std::fabs (steadyState - static_cast<float> (c.steadyTemp));
+        if (error > WarmupCurveFit::CONFIDENCE)
+        {
+            std::cerr << "[ERROR] " << c.name << ": stopped at " << seconds << " s predicting "
+                      << steadyState << " +- " << bound << ", steady state is "
+                      << c.steadyTemp << std::endl;
+            return false;
+        }
+        std::clog << c.name << ": stopped at " << seconds << " s predicting "
+                  << steadyState << " +- " << bound << std::endl;
+        return true;
+    }
+
+    if (c.mustStop)
+    {
+        std::cerr << "[ERROR] " << c.name << ": did not stop within " << c.maxSeconds << " s" << std::endl;
+        return false;
+    }
+    std::clog << c.name << ": ran to the " << c.maxSeconds << " s limit" << std::endl;
+    return true;
+}
+
+int main()
+{
+    const Curve curves[] = {
+        // name                   start  steady  tau    fps  noise  quant  max   mustStop
+        { "clean_tau20",          30.0,  45.0,   20.0,  5,   0.0,   0.0,   300,  true },
+        { "noisy_tau20",          30.0,  45.0,   20.0,  5,   0.3,   0.0,   300,  true },
+        { "noisy_tau30_45fps",    30.0,  45.0,   30.0,  45,  0.3,   0.0,   300,  true },
+        { "quantised_tau30",      30.0,  45.0,   30.0,  5,   0.3,   1.0,   300,  false },
+        { "noisy_tau300",         30.0,  45.0,   300.0, 5,   0.3,   0.0,   300,  false },
+        { "noisy_tau600_45fps",   30.0,  45.0,   600.0, 45,  0.3,   0.0,   300,  false },
+        { "quantised_tau300",     30.0,  45.0,   300.0, 5,   0.3,   1.0,   300,  false },
+        { "quantised_clean_tau300", 30.0, 45.0,  300.0, 5,   0.0,   1.0,   300,  false },
+        { "flat_noisy",           45.0,  45.0,   20.0,  5,   0.3,   0.0,   300,  false },
+    };
+
+    int failures = 0;
+    for (const auto& c : curves)
+    {
+        if (!runCurve (c))
+        {
+            failures++;
+        }
+    }
+
+    if (failures != 0)
+    {
+        std::cerr << "[ERROR] " << failures << " warm-up curve(s) failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::clog << "[SUCCESS] All warm-up fit tests passed. " << std::endl;
+    return 0;
+}